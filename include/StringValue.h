@@ -0,0 +1,241 @@
+#ifndef STRINGVALUE_H
+#define STRINGVALUE_H
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Immutable string used for script values.
+// Short strings are stored inline, longer ones share a heap node. Concatenation
+// builds a rope node in constant time and substrings are views into a shared
+// node, so neither copies character data. A rope is flattened only when its
+// contiguous contents are needed, and the result is cached in the node.
+class StringValue {
+public:
+    static constexpr size_t npos = std::string::npos;
+
+    StringValue() = default;
+
+    explicit StringValue(const std::string& text) : StringValue(std::string(text)) {}
+
+    explicit StringValue(std::string&& text) : length(text.size()) {
+        if (length <= inlineCapacity) {
+            std::memcpy(inlineData, text.data(), length);
+        } else {
+            node = makeLeaf(std::move(text));
+        }
+    }
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    // Join two strings without copying their contents
+    StringValue concat(const StringValue& other) const;
+
+    // View a part of the string, sharing the underlying storage
+    StringValue substr(size_t pos, size_t count = npos) const;
+
+    // Contiguous view of the contents, flattening a rope if needed
+    std::string_view view() const;
+
+    // Copy the contents into a std::string
+    std::string str() const { return std::string(view()); }
+
+    // Append the contents to an existing string without flattening
+    void appendTo(std::string& out) const {
+        out.reserve(out.size() + length);
+        forEachChunk([&](const char* data, size_t count) { out.append(data, count); });
+    }
+
+    // Write the contents to a stream without flattening
+    void writeTo(std::ostream& out) const {
+        forEachChunk([&](const char* data, size_t count) { out.write(data, static_cast<std::streamsize>(count)); });
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const StringValue& value) {
+        value.writeTo(out);
+        return out;
+    }
+
+private:
+    struct Node;
+
+    static constexpr size_t inlineCapacity = 16;
+
+    // Short pieces are copied together up to this size rather than linked by a
+    // new node, so building a string line by line doesn't cost a node per line
+    static constexpr size_t mergeCapacity = 1024;
+
+    // Null for inline strings; otherwise a leaf or concat node
+    std::shared_ptr<const Node> node;
+    size_t length = 0;
+    // Which member is in use follows from node, not from the last assignment:
+    // concat and substr memcpy into inlineData while offset is the member that
+    // was initialized. That relies on byte-level access to a trivially copyable
+    // union, so keep both members trivial (no std::string or similar here).
+    union {
+        size_t offset = 0;                 // Start of the view when node is set
+        char inlineData[inlineCapacity];   // Characters when node is null
+    };
+
+    static std::shared_ptr<const Node> makeLeaf(std::string&& text);
+
+    // Visit the contiguous pieces of the string in order, without recursion
+    template <typename Visitor>
+    void forEachChunk(Visitor&& visit) const;
+
+    // Turn a rope node into a leaf holding the joined contents
+    void flatten() const;
+};
+
+struct StringValue::Node {
+    // Leaf contents, or the cached contents of a flattened concat node
+    mutable std::string flat;
+    mutable bool isFlat = true;
+
+    // Children of a concat node; released once it has been flattened
+    mutable StringValue left;
+    mutable StringValue right;
+
+    ~Node() {
+        // Release long chains iteratively so deep ropes don't overflow the stack
+        std::vector<std::shared_ptr<const Node>> pending;
+        detachChildren(*this, pending);
+        while (!pending.empty()) {
+            std::shared_ptr<const Node> current = std::move(pending.back());
+            pending.pop_back();
+            if (current.use_count() == 1) {
+                detachChildren(*current, pending);
+            }
+        }
+    }
+
+    static void detachChildren(const Node& target, std::vector<std::shared_ptr<const Node>>& pending) {
+        if (target.left.node) pending.push_back(std::move(target.left.node));
+        if (target.right.node) pending.push_back(std::move(target.right.node));
+    }
+};
+
+inline std::shared_ptr<const StringValue::Node> StringValue::makeLeaf(std::string&& text) {
+    auto leaf = std::make_shared<Node>();
+    leaf->flat = std::move(text);
+    return leaf;
+}
+
+inline StringValue StringValue::concat(const StringValue& other) const {
+    if (other.empty()) return *this;
+    if (empty()) return other;
+
+    StringValue result;
+    result.length = length + other.length;
+
+    if (result.length <= inlineCapacity) {
+        size_t written = 0;
+        forEachChunk([&](const char* data, size_t count) {
+            std::memcpy(result.inlineData + written, data, count);
+            written += count;
+        });
+        other.forEachChunk([&](const char* data, size_t count) {
+            std::memcpy(result.inlineData + written, data, count);
+            written += count;
+        });
+        return result;
+    }
+
+    StringValue left = *this;
+    StringValue right = other;
+    if (other.length <= mergeCapacity) {
+        if (length <= mergeCapacity) {
+            std::string merged;
+            merged.reserve(length + other.length);
+            appendTo(merged);
+            other.appendTo(merged);
+            return StringValue(std::move(merged));
+        }
+        if (!node->isFlat && node->right.length + other.length <= mergeCapacity) {
+            std::string merged;
+            merged.reserve(node->right.length + other.length);
+            node->right.appendTo(merged);
+            other.appendTo(merged);
+            left = node->left;
+            right = StringValue(std::move(merged));
+        }
+    }
+
+    auto joined = std::make_shared<Node>();
+    joined->isFlat = false;
+    joined->left = std::move(left);
+    joined->right = std::move(right);
+    result.node = std::move(joined);
+    result.offset = 0;
+    return result;
+}
+
+inline StringValue StringValue::substr(size_t pos, size_t count) const {
+    if (pos > length) {
+        throw std::out_of_range("String index out of range: " + std::to_string(pos));
+    }
+    count = std::min(count, length - pos);
+
+    StringValue result;
+    result.length = count;
+
+    if (!node) {
+        std::memcpy(result.inlineData, inlineData + pos, count);
+        return result;
+    }
+
+    flatten();
+    if (count <= inlineCapacity) {
+        std::memcpy(result.inlineData, node->flat.data() + offset + pos, count);
+        return result;
+    }
+
+    result.node = node;
+    result.offset = offset + pos;
+    return result;
+}
+
+inline std::string_view StringValue::view() const {
+    if (!node) return std::string_view(inlineData, length);
+    flatten();
+    return std::string_view(node->flat.data() + offset, length);
+}
+
+template <typename Visitor>
+void StringValue::forEachChunk(Visitor&& visit) const {
+    std::vector<const StringValue*> stack{this};
+    while (!stack.empty()) {
+        const StringValue* piece = stack.back();
+        stack.pop_back();
+
+        if (!piece->node) {
+            if (piece->length > 0) visit(piece->inlineData, piece->length);
+        } else if (piece->node->isFlat) {
+            visit(piece->node->flat.data() + piece->offset, piece->length);
+        } else {
+            stack.push_back(&piece->node->right);
+            stack.push_back(&piece->node->left);
+        }
+    }
+}
+
+inline void StringValue::flatten() const {
+    if (!node || node->isFlat) return;
+
+    std::string joined;
+    appendTo(joined);
+
+    node->flat = std::move(joined);
+    node->isFlat = true;
+    node->left = StringValue();
+    node->right = StringValue();
+}
+
+#endif
@@ -4,18 +4,19 @@
 #include <string>
 #include <regex>
 
+// Patterns are compiled once and shared, since they are matched on every line
 class Syntax {
 public:
     std::string getPrintKeyword() const { return "print"; }
-    std::regex getLambdaRegex() const { return std::regex(R"((\w+)\((.*?)\)\s*=>\s*(.*))"); }
-    std::regex getPrintRegex() const { return std::regex(R"(^print\s*\((.*)\)\s*$)"); }
-    std::regex getExpressionRegex() const { return std::regex(R"(\{(.*?)\})"); }
-    std::regex getCommentRegex() const { return std::regex(R"(\s*//.*)"); }
-    std::regex getMultiLineCommentStartRegex() const { return std::regex(R"(\s*/\*.*)"); }
-    std::regex getMultiLineCommentEndRegex() const { return std::regex(R"(.*\*/\s*)"); }
-    std::regex getFunctionDefinitionRegex() const { return std::regex(R"(fn\s+(\w+)\((.*?)\)\s*\{)"); }
-    std::regex getFunctionCallRegex() const { return std::regex(R"((\w+)\((.*?)\))"); }
-    std::regex getVariableRegex() const { return std::regex(R"(^(\w+)\s*=\s*(.*)$)"); }
+    const std::regex& getLambdaRegex() const { static const std::regex pattern(R"((\w+)\((.*?)\)\s*=>\s*(.*))"); return pattern; }
+    const std::regex& getPrintRegex() const { static const std::regex pattern(R"(^print\s*\((.*)\)\s*$)"); return pattern; }
+    const std::regex& getExpressionRegex() const { static const std::regex pattern(R"(\{(.*?)\})"); return pattern; }
+    const std::regex& getCommentRegex() const { static const std::regex pattern(R"(\s*//.*)"); return pattern; }
+    const std::regex& getMultiLineCommentStartRegex() const { static const std::regex pattern(R"(\s*/\*.*)"); return pattern; }
+    const std::regex& getMultiLineCommentEndRegex() const { static const std::regex pattern(R"(.*\*/\s*)"); return pattern; }
+    const std::regex& getFunctionDefinitionRegex() const { static const std::regex pattern(R"(fn\s+(\w+)\((.*?)\)\s*\{)"); return pattern; }
+    const std::regex& getFunctionCallRegex() const { static const std::regex pattern(R"((\w+)\((.*?)\))"); return pattern; }
+    const std::regex& getVariableRegex() const { static const std::regex pattern(R"(^(\w+)\s*=\s*(.*)$)"); return pattern; }
 };
 
 #endif
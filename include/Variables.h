@@ -8,9 +8,12 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <regex>
+#include <cctype>
+#include "../include/StringValue.h"
 
 // A variant type to support multiple data types
-using VariableValue = std::variant<std::string, int, double, bool, std::vector<std::string>, std::map<std::string, int>>;
+using VariableValue = std::variant<StringValue, int, double, bool, std::vector<std::string>, std::map<std::string, int>>;
 
 class Variables {
 private:
@@ -29,8 +32,12 @@ public:
             variables[name] = parseArray(value);
         } else if (isDictionary(value)) {
             variables[name] = parseDictionary(value);
+        } else if (isSlice(value)) {
+            variables[name] = parseSlice(value);
+        } else if (isTemplate(value)) {
+            variables[name] = interpolate(StringValue(value).substr(2, value.size() - 3));
         } else {
-            variables[name] = trimQuotes(value);
+            variables[name] = StringValue(trimQuotes(value));
         }
     }
 
@@ -49,8 +56,10 @@ public:
 
     // Add this method to stringify VariableValue
     std::string stringifyValue(const VariableValue& value) const {
-        if (std::holds_alternative<std::string>(value)) {
-            return std::get<std::string>(value);
+        if (std::holds_alternative<StringValue>(value)) {
+            std::string result;
+            std::get<StringValue>(value).appendTo(result);
+            return result;
         } else if (std::holds_alternative<int>(value)) {
             return std::to_string(std::get<int>(value));
         } else if (std::holds_alternative<double>(value)) {
@@ -86,7 +95,133 @@ public:
         return "";
     }
 
+    // Write a value to a stream, streaming strings without copying them
+    void writeValue(std::ostream& out, const VariableValue& value) const {
+        if (std::holds_alternative<StringValue>(value)) {
+            out << std::get<StringValue>(value);
+        } else {
+            out << stringifyValue(value);
+        }
+    }
+
+    // Append a value to a string, copying string contents only once
+    void appendValue(std::string& out, const VariableValue& value) const {
+        if (std::holds_alternative<StringValue>(value)) {
+            std::get<StringValue>(value).appendTo(out);
+        } else {
+            out += stringifyValue(value);
+        }
+    }
+
+    // Append text to a string with {name} placeholders replaced by variable
+    // values. Undefined names are an error.
+    void appendInterpolated(std::string& out, const std::string& text) const {
+        out.reserve(out.size() + text.size());
+        scanPlaceholders(text, true,
+            [&](size_t start, size_t count) { out.append(text, start, count); },
+            [&](const VariableValue& value) { appendValue(out, value); });
+    }
+
+    // Check if a string is a slice of a string variable: name[start:end]
+    bool isSlice(const std::string& value) const {
+        return std::regex_match(value, sliceRegex());
+    }
+
+    // Take a slice of a string variable, sharing its storage
+    StringValue parseSlice(const std::string& value) const {
+        std::smatch match;
+        std::regex_match(value, match, sliceRegex());
+        std::string varName = match[1];
+
+        VariableValue source = getVariable(varName);
+        if (!std::holds_alternative<StringValue>(source)) {
+            throw std::runtime_error("Variable is not a string: " + varName);
+        }
+
+        const auto& text = std::get<StringValue>(source);
+        size_t start = 0;
+        size_t end = 0;
+        try {
+            start = std::stoul(match[2]);
+            end = std::stoul(match[3]);
+        } catch (const std::out_of_range&) {
+            throw std::runtime_error("Slice out of bounds: " + value);
+        }
+        if (start > end || end > text.size()) {
+            throw std::runtime_error("Slice out of bounds: " + value);
+        }
+        return text.substr(start, end - start);
+    }
+
 private:
+    // Replace {name} placeholders in a template literal with variable values.
+    // Undefined names are kept as written. Literal parts are views into the
+    // source and string variables are shared, so building a string by repeated
+    // interpolation stays linear.
+    StringValue interpolate(const StringValue& text) const {
+        StringValue result;
+        scanPlaceholders(text.view(), false,
+            [&](size_t start, size_t count) { result = result.concat(text.substr(start, count)); },
+            [&](const VariableValue& value) {
+                if (std::holds_alternative<StringValue>(value)) {
+                    result = result.concat(std::get<StringValue>(value));
+                } else {
+                    result = result.concat(StringValue(stringifyValue(value)));
+                }
+            });
+        return result;
+    }
+
+    // Walk the {name} placeholders in text, passing the literal text between them
+    // to onLiteral(start, count) and each variable value to onValue. Undefined
+    // names throw when strict, otherwise they stay part of the literal text.
+    template <typename LiteralHandler, typename ValueHandler>
+    void scanPlaceholders(std::string_view text, bool strict,
+                          LiteralHandler&& onLiteral, ValueHandler&& onValue) const {
+        size_t literalStart = 0;
+        size_t pos = 0;
+
+        while ((pos = text.find('{', pos)) != std::string_view::npos) {
+            size_t end = pos + 1;
+            while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) {
+                ++end;
+            }
+            if (end == pos + 1 || end == text.size() || text[end] != '}') {
+                ++pos;
+                continue;
+            }
+
+            std::string varName(text.substr(pos + 1, end - pos - 1));
+            auto found = variables.find(varName);
+            if (found == variables.end()) {
+                if (strict) {
+                    throw std::runtime_error("Undefined variable: " + varName);
+                }
+                pos = end + 1;
+                continue;
+            }
+
+            onLiteral(literalStart, pos - literalStart);
+            onValue(found->second);
+
+            pos = end + 1;
+            literalStart = pos;
+        }
+
+        onLiteral(literalStart, text.size() - literalStart);
+    }
+
+    // Pattern for name[start:end], compiled once
+    static const std::regex& sliceRegex() {
+        static const std::regex pattern(R"(^(\w+)\[(\d+):(\d+)\]$)");
+        return pattern;
+    }
+
+    // Helper to check if a string is a template literal: $"..."
+    bool isTemplate(const std::string& value) const {
+        return value.size() >= 3 && value[0] == '$' && value[1] == '"' && value.back() == '"';
+    }
+
     // Helper to check if a string is an integer
     bool isInteger(const std::string& value) const {
         return !value.empty() && value.find_first_not_of("-0123456789") == std::string::npos;
@@ -71,7 +71,10 @@ private:
         try {
             if (variables.hasVariable(content)) {
                 VariableValue value = variables.getVariable(content);
-                std::cout << variables.stringifyValue(value) << std::endl;
+                variables.writeValue(std::cout, value);
+                std::cout << std::endl;
+            } else if (variables.isSlice(content)) {
+                std::cout << variables.parseSlice(content) << std::endl;
             } else if (std::regex_match(content, std::regex(R"(^(\w+)\[(\d+)\]$)"))) {
                 std::smatch match;
                 std::regex_match(content, match, std::regex(R"(^(\w+)\[(\d+)\]$)"));
@@ -124,17 +127,8 @@ private:
     }
 
     std::string replaceVariables(const std::string& content) {
-        std::regex varRegex(R"(\{(\w+)\})");
-        std::smatch match;
-        std::string result = content;
-        while (std::regex_search(result, match, varRegex)) {
-            std::string varName = match[1];
-            if (!variables.hasVariable(varName)) {
-                throw std::runtime_error("Undefined variable: " + varName);
-            }
-            VariableValue value = variables.getVariable(varName);
-            result.replace(match.position(), match.length(), variables.stringifyValue(value));
-        }
+        std::string result;
+        variables.appendInterpolated(result, content);
         return result;
     }
 